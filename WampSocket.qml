@@ -83,6 +83,7 @@ Item
         property var callbacks: ({})
         property var results: ({})
         property var cancels: ({})
+        property var timeouts: ({})
 
         function sendArgs()
         {
@@ -100,12 +101,27 @@ Item
             switch(state)
             {
             case WebSocketClient.OPEN: sendArgs(_HELLO, realm, { roles: clientRoles }); break;
-            case WebSocketClient.CLOSED: closed(); break;
+            case WebSocketClient.CLOSED:
+            {
+                Object.keys(timeouts).forEach(function(requestId) { expire(requestId, 'wamp.error.canceled', false) })
+                _.requesting = isRequesting()
+                closed()
+                break;
+            }
             }
         }
 
         onHeaderReceived: _.header(header)
 
+        onTimeout:
+        {
+            if(requestId in timeouts)
+            {
+                expire(requestId, 'wamp.error.timeout', true)
+                _.requesting = isRequesting()
+            }
+        }
+
         onMessageReceived: _worker.sendMessage({dump: dump, text: text})
 
         function isRequesting()
@@ -115,6 +131,43 @@ Item
             return false
         }
 
+        // CALL keeps options.timeout so that a supporting router cancels the callee as well,
+        // requests the router never answers (unacknowledged PUBLISH) are not armed at all
+        function arm(requestId, options, onerror, cancelable)
+        {
+            if(!options || !('timeout' in options || 'cancel' in options)) return options
+            if(options.timeout > 0 && requestId in requests)
+            {
+                var cancelOptions = cancelable && options.cancel ? ('object' === typeof options.cancel ? options.cancel : {}) : null
+                timeouts[requestId] = { onerror: onerror, cancel: cancelOptions }
+                startTimeout(requestId, Math.min(options.timeout, 0x7fffffff))
+            }
+            var stripped = {}
+            for(var key in options)
+                if('cancel' !== key && (cancelable || 'timeout' !== key))
+                    stripped[key] = options[key]
+            return stripped
+        }
+
+        function expire(requestId, error, cancelable)
+        {
+            var timeout = timeouts[requestId]
+            delete timeouts[requestId]
+            delete requests[requestId]
+            delete results[requestId]
+            if(cancelable && timeout.cancel) cancel(requestId, timeout.cancel)
+            if(timeout.onerror) timeout.onerror({ details: {}, error: error })
+        }
+
+        function disarm(requestId)
+        {
+            if(requestId in timeouts)
+            {
+                delete timeouts[requestId]
+                stopTimeout(requestId)
+            }
+        }
+
         function parsed(msg)
         {
             if(msg.result)
@@ -143,6 +196,7 @@ Item
                         var args = msg[5]
                         var kwargs = msg[6]
                         delete results[requestId]
+                        disarm(requestId)
                         if(requestId in requests)
                         {
                             var onerror = requests[requestId].onerror
@@ -159,6 +213,7 @@ Item
                     {
                         var requestId = msg[1]
                         var callbackId = msg[2]
+                        disarm(requestId)
                         if(requestId in requests)
                         {
                             var request = requests[requestId]
@@ -209,6 +264,11 @@ Item
                                  }))
                                     delete results[resultId]
                         }
+                        if(!(details && details.progress))
+                        {
+                            delete results[resultId]
+                            disarm(resultId)
+                        }
                         break;
                     }
                     case _INTERRUPT:
@@ -259,8 +319,9 @@ Item
 
         function publish(uri, options, args, kwargs, onsuccess, onerror)
         {
-            requests[++requestId] = { onsuccess: onsuccess, onerror: onerror }
-            sendArgs(_PUBLISH, requestId, options, uri, args, kwargs)
+            ++requestId
+            if(options && options.acknowledge) requests[requestId] = { onsuccess: onsuccess, onerror: onerror }
+            sendArgs(_PUBLISH, requestId, arm(requestId, options, onerror, false), uri, args, kwargs)
             return requestId
         }
 
@@ -268,7 +329,7 @@ Item
         {
             requests[++requestId] = { onerror: onerror }
             results[requestId] = callback
-            sendArgs(_ws._CALL, requestId, options, uri, args, kwargs)
+            sendArgs(_ws._CALL, requestId, arm(requestId, options, onerror, true), uri, args, kwargs)
             return requestId
         }
 
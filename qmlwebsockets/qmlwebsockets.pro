@@ -12,6 +12,7 @@ SOURCES += \
 
 HEADERS += \
     qmlwebsockets_plugin.h \
+    timerwheel.h \
     websocketclient.h
 
 DISTFILES = qmldir \
@@ -0,0 +1,103 @@
+/*
+** hierarchical timer wheel driving call/publish timeouts on the websocket thread
+** https://github.com/undwad/qmlwamp mailto:undwad@mail.ru
+** see copyright notice in ./LICENCE
+*/
+
+#pragma once
+
+#include <list>
+#include <QtGlobal>
+#include <QHash>
+
+// LEVELS wheels of SLOTS slots each, every level SLOTS times coarser than the previous one.
+// start/stop are O(1), each tick expires the current slot and cascades a coarser slot
+// only when the finer wheel wraps around, so the cost does not depend on timer count.
+class TimerWheel
+{
+public:
+    enum
+    {
+        SLOT_BITS = 6,
+        SLOTS = 1 << SLOT_BITS,
+        SLOT_MASK = SLOTS - 1,
+        LEVELS = 4,
+        MAX_TICKS = (1 << (SLOT_BITS * LEVELS)) - 1,
+    };
+
+    bool isEmpty() const { return _positions.isEmpty(); }
+
+    void start(int id, quint64 ticks)
+    {
+        stop(id);
+        std::list<Entry> pending;
+        pending.push_back({ id, _now + qBound<quint64>(1, ticks, MAX_TICKS) });
+        place(pending, pending.begin());
+    }
+
+    void stop(int id)
+    {
+        auto position = _positions.find(id);
+        if(_positions.end() == position) return;
+        position->slot->erase(position->entry);
+        _positions.erase(position);
+    }
+
+    void clear()
+    {
+        for(auto& level : _slots)
+            for(auto& slot : level)
+                slot.clear();
+        _positions.clear();
+    }
+
+    template <typename Expired>
+    void advance(quint64 ticks, Expired expired)
+    {
+        while(ticks-- && !isEmpty())
+        {
+            int index = ++_now & SLOT_MASK;
+            for(int level = 1; !index && level < LEVELS; level++)
+                cascade(level, index = (_now >> (SLOT_BITS * level)) & SLOT_MASK);
+
+            std::list<Entry> due;
+            due.swap(_slots[0][_now & SLOT_MASK]);
+            for(const Entry& entry : due) _positions.remove(entry.id);
+            for(const Entry& entry : due) expired(entry.id);
+        }
+    }
+
+private:
+    struct Entry
+    {
+        int id;
+        quint64 expires;
+    };
+
+    struct Position
+    {
+        std::list<Entry>* slot;
+        std::list<Entry>::iterator entry;
+    };
+
+    quint64 _now = 0;
+    std::list<Entry> _slots[LEVELS][SLOTS];
+    QHash<int, Position> _positions;
+
+    void place(std::list<Entry>& from, std::list<Entry>::iterator entry)
+    {
+        quint64 delta = entry->expires - _now;
+        int level = 0;
+        while(level < LEVELS - 1 && delta >> (SLOT_BITS * (level + 1))) level++;
+        std::list<Entry>& slot = _slots[level][(entry->expires >> (SLOT_BITS * level)) & SLOT_MASK];
+        slot.splice(slot.end(), from, entry);
+        _positions[entry->id] = { &slot, entry };
+    }
+
+    void cascade(int level, int index)
+    {
+        std::list<Entry> pending;
+        pending.swap(_slots[level][index]);
+        while(!pending.empty()) place(pending, pending.begin());
+    }
+};
@@ -19,8 +19,12 @@
 #include <QByteArray>
 #include <QList>
 #include <QSslError>
+#include <QTimer>
+#include <QElapsedTimer>
 #include <QDebug>
 
+#include "timerwheel.h"
+
 //#include <gunzip.h>
 
 #define EMIT_ERROR_AND_RETURN(MESSAGE, DETAILS, RESULT) \
@@ -59,6 +63,7 @@ signals:
     void headerReceived(const QString& header);
     void messageReceived(const QString& message);
     void socketError(const QString& message, const QString& details);
+    void timeout(int requestId);
 
 public slots:
     void open
@@ -126,9 +131,32 @@ public slots:
 
     void abort() { socket().abort(); }
 
+    // msec <= 0 means no timer, longer than TimerWheel::MAX_TICKS * TICK_MSEC (about 46 h) is capped
+    void startTimeout(int requestId, int msec)
+    {
+        if(msec <= 0) return;
+        if(_wheel.isEmpty())
+        {
+            _ticks = _clock.elapsed() / TICK_MSEC;
+            _ticker.start();
+        }
+        else advance();
+        // one extra tick covers the part of the current tick that has already elapsed
+        _wheel.start(requestId, ((qint64)msec + TICK_MSEC - 1) / TICK_MSEC + 1);
+    }
+
+    void stopTimeout(int requestId)
+    {
+        _wheel.stop(requestId);
+        if(_wheel.isEmpty()) _ticker.stop();
+    }
+
 public:
     WebSocketWorker()
     {
+        _clock.start();
+        _ticker.setInterval(TICK_MSEC);
+        connect(&_ticker, &QTimer::timeout, this, &WebSocketWorker::tick);
         connect(&_socket, &QTcpSocket::connected, this, &WebSocketWorker::connected);
         connect(&_socket, &QTcpSocket::readyRead, this, &WebSocketWorker::readyRead);
         connect(&_socket, SIGNAL(error(QAbstractSocket::SocketError)), this, SLOT(error(QAbstractSocket::SocketError)));
@@ -153,6 +181,7 @@ public:
 #       if !defined(QT_NO_SSL)
         _sslsocket.moveToThread(thread);
 #       endif
+        _ticker.moveToThread(thread);
     }
 
 private slots:
@@ -207,9 +236,21 @@ private slots:
 
     void error(QAbstractSocket::SocketError code) { emit socketError(socket().errorString(), QString(code)); }
     void aboutToClose() { emit stateChanged(_state = ReadyState::CLOSING); }
-    void disconnected() { emit stateChanged(_state = ReadyState::CLOSED); }
+    void disconnected()
+    {
+        clearTimeouts();
+        emit stateChanged(_state = ReadyState::CLOSED);
+    }
+
+    void tick()
+    {
+        advance();
+        if(_wheel.isEmpty()) _ticker.stop();
+    }
 
 private:
+    enum { TICK_MSEC = 10 };
+
     QTcpSocket _socket;
 #if !defined(QT_NO_SSL)
     QSslSocket _sslsocket;
@@ -222,6 +263,10 @@ private:
     ReadyState _state = ReadyState::CLOSED;
     bool _mask;
     std::vector<qint8> _input_data;
+    TimerWheel _wheel;
+    QTimer _ticker;
+    QElapsedTimer _clock;
+    qint64 _ticks = 0;
 
     inline QAbstractSocket& socket()
     {
@@ -231,6 +276,19 @@ private:
         return _socket;
     }
 
+    void advance()
+    {
+        qint64 ticks = _clock.elapsed() / TICK_MSEC;
+        _wheel.advance(ticks - _ticks, [this](int requestId) { emit timeout(requestId); });
+        _ticks = ticks;
+    }
+
+    void clearTimeouts()
+    {
+        _wheel.clear();
+        _ticker.stop();
+    }
+
     void sendData(wsheader_type::opcode_type type, QByteArray data)
     {
         const quint8 masking_key[4] = { 0x12, 0x34, 0x56, 0x78 };
@@ -423,11 +481,14 @@ signals:
     void toSend(const QString& message);
     void toClose();
     void toAbort();
+    void toStartTimeout(int requestId, int msec);
+    void toStopTimeout(int requestId);
 
     void stateChanged(ReadyState state);
     void messageReceived(const QString& text);
     void socketError(const QString& message, const QString& details);
     void headerReceived(const QString& header);
+    void timeout(int requestId);
 
 public:
     WebSocketClient(QQuickItem *parent = 0) : QObject(parent), _worker(new WebSocketWorker)
@@ -438,11 +499,14 @@ public:
         connect(_worker, &WebSocketWorker::headerReceived, this, &WebSocketClient::onHeaderReceived);
         connect(_worker, &WebSocketWorker::messageReceived, this, &WebSocketClient::onMessageReceived);
         connect(_worker, &WebSocketWorker::socketError, this, &WebSocketClient::onSocketError);
+        connect(_worker, &WebSocketWorker::timeout, this, &WebSocketClient::onTimeout);
         connect(this, &WebSocketClient::toOpen, _worker, &WebSocketWorker::open);
         connect(this, &WebSocketClient::toPing, _worker, &WebSocketWorker::ping);
         connect(this, &WebSocketClient::toSend, _worker, &WebSocketWorker::send);
         connect(this, &WebSocketClient::toClose, _worker, &WebSocketWorker::close);
         connect(this, &WebSocketClient::toAbort, _worker, &WebSocketWorker::abort);
+        connect(this, &WebSocketClient::toStartTimeout, _worker, &WebSocketWorker::startTimeout);
+        connect(this, &WebSocketClient::toStopTimeout, _worker, &WebSocketWorker::stopTimeout);
         _thread.start();
     }
 
@@ -460,12 +524,15 @@ public slots:
     void send(const QString& text) { emit toSend(text); }
     void close() { emit toClose(); }
     void abort() { emit toAbort(); }
+    void startTimeout(int requestId, int msec) { emit toStartTimeout(requestId, msec); }
+    void stopTimeout(int requestId) { emit toStopTimeout(requestId); }
 
 private slots:
     void onStateChanged(int state) { if((ReadyState)state != _state) emit stateChanged(_state = (ReadyState)state); }
     void onHeaderReceived(const QString& header) { emit headerReceived(header); }
     void onMessageReceived(const QString& message) { emit messageReceived(message); }
     void onSocketError(const QString& message, const QString& details) { emit socketError(message, details); }
+    void onTimeout(int requestId) { emit timeout(requestId); }
 
 private:
     WebSocketWorker* _worker;